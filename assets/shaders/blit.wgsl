@@ -0,0 +1,36 @@
+struct BlitParams {
+    uvScale: vec2f,
+    padding: vec2f,
+};
+
+@group(0) @binding(0) var sceneTexture: texture_2d<f32>;
+@group(0) @binding(1) var sceneSampler: sampler;
+@group(0) @binding(2) var<uniform> params: BlitParams;
+
+struct VertexOutput {
+    @builtin(position) position: vec4f,
+    @location(0) uv: vec2f,
+};
+
+// Single triangle that covers the whole screen
+@vertex
+fn vs_main(@builtin(vertex_index) index: u32) -> VertexOutput {
+    var output: VertexOutput;
+
+    let pos = vec2f(f32((index << 1u) & 2u), f32(index & 2u)) * 2.0 - 1.0;
+
+    output.position = vec4f(pos, 0.0, 1.0);
+    output.uv = vec2f(pos.x * 0.5 + 0.5, 0.5 - pos.y * 0.5);
+
+    return output;
+}
+
+@fragment
+fn fs_main(input: VertexOutput) -> @location(0) vec4f {
+    // Only the top-left uvScale region holds this frame's image; keep the
+    // bilinear footprint inside it so unrendered texels don't bleed in
+    let halfTexel = 0.5 / vec2f(textureDimensions(sceneTexture));
+    let uv = clamp(input.uv * params.uvScale, halfTexel, params.uvScale - halfTexel);
+
+    return textureSample(sceneTexture, sceneSampler, uv);
+}
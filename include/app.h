@@ -5,10 +5,12 @@
 #include <GLFW/glfw3.h>
 
 #include "helper.h"
+#include "scaling.h"
+#include "timing.h"
 
 class Application {
 public:
-    bool init();
+    bool init(const ResolutionScaleSettings& scaling = {});
     void mainLoop();
     void terminate();
 
@@ -21,12 +23,29 @@ private:
     wgpu::Device device;
     wgpu::Queue queue;
     wgpu::Surface surface;
+    wgpu::TextureFormat surfaceFormat = wgpu::TextureFormat::Undefined;
+    uint32_t surfaceWidth = 0;
+    uint32_t surfaceHeight = 0;
 
     // resources
     Geometry geometry;
 
+    // adaptive resolution
+    ResolutionScaleSettings scalingSettings;
+    FrameTimeController frameTimeController;
+    FrameTimer frameTimer;
+    OffscreenTarget offscreen;
+    wgpu::RenderPipeline blitPipeline;
+    wgpu::Sampler blitSampler;
+    wgpu::Buffer blitParams;
+    wgpu::BindGroup blitBindGroup;
+
     // functions
     void initializeBuffers();
+    void initializeScaling();
+    void drawScene(wgpu::RenderPassEncoder& pass);
+    void renderDirect(wgpu::CommandEncoder& encoder, wgpu::TextureView targetView);
+    void renderScaled(wgpu::CommandEncoder& encoder, wgpu::TextureView targetView);
 };
 
 #endif // APP_H
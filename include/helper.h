@@ -65,6 +65,13 @@ static wgpu::Device getDevice(wgpu::Adapter& adapter) {
     wgpu::Limits requiredLimits = getRequiredLimits(adapter);
     deviceDesc.requiredLimits = &requiredLimits;
 
+    // Timestamp queries are optional; they let frame timing measure GPU time directly
+    WGPUFeatureName timestampFeature = WGPUFeatureName_TimestampQuery;
+    if (adapter.hasFeature(timestampFeature)) {
+        deviceDesc.requiredFeatureCount = 1;
+        deviceDesc.requiredFeatures = &timestampFeature;
+    }
+
     wgpu::Device device = adapter.requestDevice(deviceDesc);
     if (!device) {
         std::cerr << "Failed to request device\n";
@@ -75,7 +82,7 @@ static wgpu::Device getDevice(wgpu::Adapter& adapter) {
 }
 
 // Configures the WebGPU surface with the provided adapter and device
-static inline void configureSurface(wgpu::Surface& surface, wgpu::Adapter& adapter, wgpu::Device& device) {
+static inline void configureSurface(wgpu::Surface& surface, wgpu::Adapter& adapter, wgpu::Device& device, uint32_t width, uint32_t height) {
     wgpu::SurfaceConfiguration config = {};
     config.device = device;
     config.usage = wgpu::TextureUsage::RenderAttachment;
@@ -83,8 +90,8 @@ static inline void configureSurface(wgpu::Surface& surface, wgpu::Adapter& adapt
     config.alphaMode = wgpu::CompositeAlphaMode::Auto;
     config.viewFormatCount = 0;
     config.viewFormats = nullptr;
-    config.width = 800;
-    config.height = 600;
+    config.width = width;
+    config.height = height;
 
     wgpu::SurfaceCapabilities capabilities;
     surface.getCapabilities(adapter, &capabilities);
@@ -95,4 +95,66 @@ wgpu::RenderPipeline createTrianglePipeline(
     return device.createRenderPipeline(pipelineDesc);
 }
 
+// -----------------------------------------------------------------------------
+// Creates the pipeline that upscales the offscreen scene onto the surface.
+// -----------------------------------------------------------------------------
+wgpu::RenderPipeline createBlitPipeline(
+    wgpu::Device device,
+    wgpu::TextureFormat surfaceTextureFormat,
+    wgpu::ShaderModule shader)
+{
+    wgpu::RenderPipelineDescriptor pipelineDesc{};
+    pipelineDesc.label = toStringView("Blit Pipeline");
+
+    // ----------------------------------------
+    // Vertex Stage Configuration (positions come from vertex_index)
+    // ----------------------------------------
+    pipelineDesc.vertex.bufferCount = 0;
+    pipelineDesc.vertex.buffers = nullptr;
+    pipelineDesc.vertex.module = shader;
+    pipelineDesc.vertex.entryPoint = toStringView("vs_main");
+    pipelineDesc.vertex.constantCount = 0;
+    pipelineDesc.vertex.constants = nullptr;
+
+    // ----------------------------------------
+    // Primitive Configuration
+    // ----------------------------------------
+    pipelineDesc.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
+    pipelineDesc.primitive.stripIndexFormat = wgpu::IndexFormat::Undefined;
+    pipelineDesc.primitive.frontFace = wgpu::FrontFace::CCW;
+    pipelineDesc.primitive.cullMode = wgpu::CullMode::None;
+
+    // ----------------------------------------
+    // Fragment Stage Configuration (no blending, overwrite the surface)
+    // ----------------------------------------
+    wgpu::FragmentState fragmentState{};
+    fragmentState.module = shader;
+    fragmentState.entryPoint = toStringView("fs_main");
+
+    static wgpu::ColorTargetState colorTargetState{};
+    colorTargetState.format = surfaceTextureFormat;
+    colorTargetState.blend = nullptr;
+    colorTargetState.writeMask = wgpu::ColorWriteMask::All;
+
+    fragmentState.targetCount = 1;
+    fragmentState.targets = &colorTargetState;
+
+    pipelineDesc.fragment = &fragmentState;
+
+    // ----------------------------------------
+    // Depth-Stencil & Multisampling (unused here)
+    // ----------------------------------------
+    pipelineDesc.depthStencil = nullptr;
+    pipelineDesc.multisample.count = 1;
+    pipelineDesc.multisample.mask = ~0u;
+    pipelineDesc.multisample.alphaToCoverageEnabled = false;
+
+    // ----------------------------------------
+    // Use auto layout (bind group 0 is read back from the pipeline)
+    // ----------------------------------------
+    pipelineDesc.layout = nullptr;
+
+    return device.createRenderPipeline(pipelineDesc);
+}
+
 #endif // PIPELINE_H
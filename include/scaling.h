@@ -0,0 +1,169 @@
+#ifndef SCALING_H
+#define SCALING_H
+
+#include <webgpu/webgpu-raii.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "helper.h"
+
+// Tuning knobs for adaptive (dynamic) resolution scaling; expects 0 < minScale <= maxScale
+struct ResolutionScaleSettings {
+    bool enabled = false;
+    double targetFrameMs = 16.6;   // frame budget the controller steers towards
+    float minScale = 0.5f;         // smallest allowed fraction of the surface size
+    float maxScale = 1.0f;         // largest allowed fraction of the surface size
+    float hysteresis = 0.1f;       // width of the dead band below the target, as a fraction of it
+    float smoothing = 0.2f;        // weight of the newest sample in the moving average
+    float minStep = 0.02f;         // ignore scale changes smaller than this
+    int cooldownSamples = 15;      // timing samples to skip at startup and ignore after each change
+};
+
+// Offscreen color target the scene is rendered into before being upscaled
+struct OffscreenTarget {
+    wgpu::Texture texture;
+    wgpu::TextureView view;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+// Uniform block read by blit.wgsl (padded to 16 bytes)
+struct BlitParams {
+    float uvScale[2];
+    float padding[2];
+};
+
+// -----------------------------------------------------------------------------
+// Picks a render scale from measured frame times.
+//
+// Frame times are smoothed with an exponential moving average. The dead band
+// sits below the budget: the scale drops as soon as the average exceeds the
+// target and only rises once it falls under target * (1 - h). Either way the
+// new scale aims for the middle of that band, so there is headroom left before
+// a frame misses vblank. Pixel cost grows with area, so the edge scale is
+// adjusted by the square root of the cost ratio. After every change the
+// controller waits out a cooldown so a single spike does not make the
+// resolution swing. Warm-up and cooldown count update() calls, i.e. timing
+// samples: those arrive a frame or two late and untimed frames produce none,
+// so they span at least as many rendered frames.
+// -----------------------------------------------------------------------------
+class FrameTimeController {
+public:
+    explicit FrameTimeController(const ResolutionScaleSettings& settings = {})
+        : settings(settings) {
+        currentScale = this->settings.maxScale;
+        warmup = this->settings.cooldownSamples;
+    }
+
+    // Feeds one frame time sample (milliseconds) and returns the scale to use next
+    float update(double frameMs) {
+        // Startup hitches (first pipeline use, shader compiles, swapchain warm-up)
+        // must not seed the average, so the first samples are dropped outright
+        if (warmup > 0) {
+            --warmup;
+            return currentScale;
+        }
+
+        averageMs = averageMs <= 0.0 ? frameMs : averageMs + settings.smoothing * (frameMs - averageMs);
+
+        if (cooldown > 0) {
+            --cooldown;
+            return currentScale;
+        }
+
+        const double lower = settings.targetFrameMs * (1.0 - settings.hysteresis);
+        if (averageMs <= 0.0 || (averageMs >= lower && averageMs <= settings.targetFrameMs)) {
+            return currentScale;
+        }
+
+        const double aimMs = settings.targetFrameMs * (1.0 - settings.hysteresis * 0.5);
+        float next = currentScale * static_cast<float>(std::sqrt(aimMs / averageMs));
+        next = std::clamp(next, settings.minScale, settings.maxScale);
+        if (std::abs(next - currentScale) >= settings.minStep) {
+            currentScale = next;
+            cooldown = settings.cooldownSamples;
+        }
+
+        return currentScale;
+    }
+
+    float scale() const { return currentScale; }
+    double averageFrameMs() const { return averageMs; }
+
+private:
+    ResolutionScaleSettings settings;
+    float currentScale = 1.0f;
+    double averageMs = 0.0;
+    int cooldown = 0;
+    int warmup = 0;
+};
+
+// Creates a texture that can be rendered to and then sampled by the blit pass
+static inline OffscreenTarget createOffscreenTarget(wgpu::Device& device, wgpu::TextureFormat format, uint32_t width, uint32_t height) {
+    OffscreenTarget target;
+    target.width = std::max(width, 1u);
+    target.height = std::max(height, 1u);
+
+    wgpu::TextureDescriptor textureDesc = wgpu::Default;
+    textureDesc.label = toStringView("Offscreen scene texture");
+    textureDesc.usage = wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::TextureBinding;
+    textureDesc.size = { target.width, target.height, 1 };
+    textureDesc.format = format;
+    textureDesc.viewFormatCount = 0;
+    textureDesc.viewFormats = nullptr;
+
+    target.texture = device.createTexture(textureDesc);
+
+    wgpu::TextureViewDescriptor viewDesc = {};
+    viewDesc.label = toStringView("Offscreen scene view");
+    viewDesc.format = format;
+    viewDesc.dimension = wgpu::TextureViewDimension::_2D;
+    viewDesc.baseMipLevel = 0;
+    viewDesc.mipLevelCount = 1;
+    viewDesc.baseArrayLayer = 0;
+    viewDesc.arrayLayerCount = 1;
+    viewDesc.aspect = wgpu::TextureAspect::All;
+
+    target.view = target.texture.createView(viewDesc);
+
+    return target;
+}
+
+// Linear sampler used to upscale the offscreen target onto the surface
+static inline wgpu::Sampler createBlitSampler(wgpu::Device& device) {
+    wgpu::SamplerDescriptor samplerDesc = wgpu::Default;
+    samplerDesc.label = toStringView("Blit sampler");
+    samplerDesc.magFilter = wgpu::FilterMode::Linear;
+    samplerDesc.minFilter = wgpu::FilterMode::Linear;
+    samplerDesc.maxAnisotropy = 1;
+
+    return device.createSampler(samplerDesc);
+}
+
+// Binds the offscreen texture, sampler and parameter buffer for blit.wgsl
+static inline wgpu::BindGroup createBlitBindGroup(wgpu::Device& device, wgpu::RenderPipeline& blitPipeline,
+                                                  const OffscreenTarget& target, wgpu::Sampler sampler, wgpu::Buffer params) {
+    wgpu::BindGroupEntry entries[3] = {};
+
+    entries[0].binding = 0;
+    entries[0].textureView = target.view;
+
+    entries[1].binding = 1;
+    entries[1].sampler = sampler;
+
+    entries[2].binding = 2;
+    entries[2].buffer = params;
+    entries[2].offset = 0;
+    entries[2].size = sizeof(BlitParams);
+
+    wgpu::BindGroupDescriptor bindGroupDesc = {};
+    bindGroupDesc.label = toStringView("Blit bind group");
+    bindGroupDesc.layout = blitPipeline.getBindGroupLayout(0);
+    bindGroupDesc.entryCount = 3;
+    bindGroupDesc.entries = entries;
+
+    return device.createBindGroup(bindGroupDesc);
+}
+
+#endif // SCALING_H
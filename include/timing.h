@@ -0,0 +1,204 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <webgpu/webgpu-raii.hpp>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "helper.h"
+
+// -----------------------------------------------------------------------------
+// Measures what each frame costs without blocking the CPU on the GPU.
+//
+// With timestamp queries, the first pass writes a begin timestamp and the last
+// pass an end timestamp. These are resolved into a small buffer that is mapped
+// asynchronously, and the sample is max(CPU encode time, GPU pass time).
+//
+// Without them, a queue.onSubmittedWorkDone callback stamps the time at which
+// the frame's work was seen to finish. That callback only runs inside the
+// loop's non-blocking device.poll, which under Fifo may come after the next
+// surface acquire has waited for vblank. Time spent inside acquire is therefore
+// subtracted, so the sample is not inflated to the refresh interval.
+//
+// Samples arrive a frame or two late; frames that find every slot busy are not
+// timed.
+// -----------------------------------------------------------------------------
+class FrameTimer {
+public:
+    void init(wgpu::Device& device) {
+        useTimestamps = device.hasFeature(wgpu::FeatureName::TimestampQuery);
+        if (!useTimestamps) {
+            return;
+        }
+
+        for (Slot& slot : slots) {
+            wgpu::QuerySetDescriptor querySetDesc;
+            querySetDesc.label = toStringView("Frame timestamps");
+            querySetDesc.type = wgpu::QueryType::Timestamp;
+            querySetDesc.count = 2;
+            slot.querySet = device.createQuerySet(querySetDesc);
+
+            wgpu::BufferDescriptor bufferDesc;
+            bufferDesc.label = toStringView("Frame timestamp resolve");
+            bufferDesc.size = 2 * sizeof(uint64_t);
+            bufferDesc.usage = wgpu::BufferUsage::QueryResolve | wgpu::BufferUsage::CopySrc;
+            bufferDesc.mappedAtCreation = false;
+            slot.resolveBuffer = device.createBuffer(bufferDesc);
+
+            bufferDesc.label = toStringView("Frame timestamp readback");
+            bufferDesc.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst;
+            slot.readbackBuffer = device.createBuffer(bufferDesc);
+        }
+    }
+
+    bool usesTimestamps() const { return useTimestamps; }
+
+    // Call once the surface texture has been acquired; returns false if this frame is not timed
+    bool beginFrame(double acquireWaitSeconds) {
+        acquireWait += acquireWaitSeconds;
+
+        current = &slots[next];
+        if (current->state != Slot::State::Idle) {
+            current = nullptr;
+            return false;
+        }
+
+        current->state = Slot::State::Recording;
+        current->cpuStart = glfwGetTime();
+        return true;
+    }
+
+    // Timestamp writes for a render pass; pass first/last to mark the frame boundaries
+    const wgpu::RenderPassTimestampWrites* passTimestampWrites(bool first, bool last) {
+        if (!current || !useTimestamps) {
+            return nullptr;
+        }
+
+        wgpu::RenderPassTimestampWrites& writes = first ? beginWrites : endWrites;
+        writes.querySet = current->querySet;
+        writes.beginningOfPassWriteIndex = first ? 0 : WGPU_QUERY_SET_INDEX_UNDEFINED;
+        writes.endOfPassWriteIndex = last ? 1 : WGPU_QUERY_SET_INDEX_UNDEFINED;
+        return &writes;
+    }
+
+    // Copies the frame's timestamps somewhere mappable; call after the last pass
+    void resolve(wgpu::CommandEncoder& encoder) {
+        if (!current || !useTimestamps) {
+            return;
+        }
+
+        encoder.resolveQuerySet(current->querySet, 0, 2, current->resolveBuffer, 0);
+        encoder.copyBufferToBuffer(current->resolveBuffer, 0, current->readbackBuffer, 0, 2 * sizeof(uint64_t));
+    }
+
+    // Call right after queue.submit
+    void endFrame(wgpu::Queue& queue) {
+        if (!current) {
+            return;
+        }
+
+        current->submitTime = glfwGetTime();
+        current->acquireWaitAtSubmit = acquireWait;
+        current->state = Slot::State::Pending;
+
+        if (useTimestamps) {
+            wgpu::BufferMapCallbackInfo callbackInfo;
+            callbackInfo.mode = wgpu::CallbackMode::AllowProcessEvents;
+            callbackInfo.callback = onReadbackMapped;
+            callbackInfo.userdata1 = current;
+            current->readbackBuffer.mapAsync(wgpu::MapMode::Read, 0, 2 * sizeof(uint64_t), callbackInfo);
+        } else {
+            wgpu::QueueWorkDoneCallbackInfo callbackInfo;
+            callbackInfo.mode = wgpu::CallbackMode::AllowProcessEvents;
+            callbackInfo.callback = onWorkDone;
+            callbackInfo.userdata1 = current;
+            callbackInfo.userdata2 = this;
+            queue.onSubmittedWorkDone(callbackInfo);
+        }
+
+        current = nullptr;
+        next = (next + 1) % slots.size();
+    }
+
+    // Returns the most recent finished sample in milliseconds, if any arrived since the last call
+    bool collect(double& frameMs) {
+        bool found = false;
+        double newestSubmit = 0.0;
+
+        for (Slot& slot : slots) {
+            if (slot.state != Slot::State::Ready) {
+                continue;
+            }
+
+            double sampleMs = 0.0;
+            if (useTimestamps) {
+                uint64_t timestamps[2] = {};
+                std::memcpy(timestamps, slot.readbackBuffer.getConstMappedRange(0, sizeof(timestamps)), sizeof(timestamps));
+                slot.readbackBuffer.unmap();
+
+                // Resolved timestamps are in nanoseconds
+                const double gpuMs = timestamps[1] > timestamps[0] ? (timestamps[1] - timestamps[0]) / 1.0e6 : 0.0;
+                const double cpuMs = (slot.submitTime - slot.cpuStart) * 1000.0;
+                sampleMs = std::max(cpuMs, gpuMs);
+            } else {
+                const double waited = slot.acquireWaitAtDone - slot.acquireWaitAtSubmit;
+                sampleMs = std::max(slot.doneTime - slot.cpuStart - waited, slot.submitTime - slot.cpuStart) * 1000.0;
+            }
+            slot.state = Slot::State::Idle;
+
+            if (!found || slot.submitTime > newestSubmit) {
+                frameMs = sampleMs;
+                newestSubmit = slot.submitTime;
+                found = true;
+            }
+        }
+
+        return found;
+    }
+
+private:
+    struct Slot {
+        enum class State { Idle, Recording, Pending, Ready };
+
+        State state = State::Idle;
+        wgpu::QuerySet querySet;
+        wgpu::Buffer resolveBuffer;
+        wgpu::Buffer readbackBuffer;
+        double cpuStart = 0.0;
+        double submitTime = 0.0;
+        double doneTime = 0.0;
+        double acquireWaitAtSubmit = 0.0;
+        double acquireWaitAtDone = 0.0;
+    };
+
+    static void onReadbackMapped(WGPUMapAsyncStatus status, WGPUStringView, void* userdata1, void*) {
+        Slot* slot = static_cast<Slot*>(userdata1);
+        slot->state = status == WGPUMapAsyncStatus_Success ? Slot::State::Ready : Slot::State::Idle;
+    }
+
+    static void onWorkDone(WGPUQueueWorkDoneStatus status, void* userdata1, void* userdata2) {
+        Slot* slot = static_cast<Slot*>(userdata1);
+        FrameTimer* timer = static_cast<FrameTimer*>(userdata2);
+        if (status != WGPUQueueWorkDoneStatus_Success) {
+            slot->state = Slot::State::Idle;
+            return;
+        }
+
+        slot->doneTime = glfwGetTime();
+        slot->acquireWaitAtDone = timer->acquireWait;
+        slot->state = Slot::State::Ready;
+    }
+
+    std::array<Slot, 3> slots;
+    Slot* current = nullptr;
+    size_t next = 0;
+    bool useTimestamps = false;
+    double acquireWait = 0.0;
+    wgpu::RenderPassTimestampWrites beginWrites;
+    wgpu::RenderPassTimestampWrites endWrites;
+};
+
+#endif // TIMING_H
@@ -1,6 +1,8 @@
 #include <webgpu/webgpu-raii.hpp>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -11,6 +13,7 @@
 #include "surface.h"
 #include "pipeline.h"
 #include "resources.h"
+#include "scaling.h"
 
 // ---------------------------------------------------------
 // Initializes GPU vertex buffer with interleaved position/color data
@@ -20,10 +23,57 @@ void Application::initializeBuffers() {
     geometry = loadGeometry2D(RESOURCE_DIR "/shape.geo", device);
 }
 
+// ---------------------------------------------------------
+// Creates the offscreen target and blit resources used by
+// adaptive resolution scaling
+// ---------------------------------------------------------
+void Application::initializeScaling() {
+    // The offscreen target is sized for maxScale, so it has to fit the device's texture limit
+    wgpu::Limits limits = {};
+    device.getLimits(&limits);
+    const float largestScale = static_cast<float>(limits.maxTextureDimension2D) / std::max(surfaceWidth, surfaceHeight);
+    if (scalingSettings.maxScale > largestScale) {
+        std::cerr << "Clamping max render scale " << scalingSettings.maxScale << " to " << largestScale
+                  << " (maxTextureDimension2D " << limits.maxTextureDimension2D << ")\n";
+        scalingSettings.maxScale = largestScale;
+        scalingSettings.minScale = std::min(scalingSettings.minScale, largestScale);
+    }
+
+    frameTimeController = FrameTimeController(scalingSettings);
+
+    // Allocate once at the largest scale; lower scales only shrink the viewport,
+    // so a load spike never triggers a texture reallocation
+    const float maxScale = frameTimeController.scale();
+    offscreen = createOffscreenTarget(device, surfaceFormat,
+        std::min(static_cast<uint32_t>(std::ceil(surfaceWidth * maxScale)), limits.maxTextureDimension2D),
+        std::min(static_cast<uint32_t>(std::ceil(surfaceHeight * maxScale)), limits.maxTextureDimension2D));
+
+    wgpu::ShaderModule blitShader = createShaderModuleWGSL(RESOURCE_DIR "/shaders/blit.wgsl", device);
+    blitPipeline = createBlitPipeline(device, surfaceFormat, blitShader);
+    blitSampler = createBlitSampler(device);
+
+    wgpu::BufferDescriptor bufferDesc;
+    bufferDesc.label = toStringView("Blit params");
+    bufferDesc.size = sizeof(BlitParams);
+    bufferDesc.usage = wgpu::BufferUsage::CopyDst | wgpu::BufferUsage::Uniform;
+    bufferDesc.mappedAtCreation = false;
+    blitParams = device.createBuffer(bufferDesc);
+
+    blitBindGroup = createBlitBindGroup(device, blitPipeline, offscreen, blitSampler, blitParams);
+
+    frameTimer.init(device);
+
+    std::cout << "Adaptive resolution: " << offscreen.width << "x" << offscreen.height
+              << " offscreen target, " << scalingSettings.targetFrameMs << " ms budget, "
+              << (frameTimer.usesTimestamps() ? "GPU timestamp" : "work-done") << " timing\n";
+}
+
 // ---------------------------------------------------------
 // Initializes GLFW, WebGPU instance, device, surface, pipeline
 // ---------------------------------------------------------
-bool Application::init() {
+bool Application::init(const ResolutionScaleSettings& scaling) {
+    scalingSettings = scaling;
+
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW\n";
         return false;
@@ -67,18 +117,112 @@ bool Application::init() {
     cbInfo.callback = callbacks::quene::queueWorkDoneCallback;
     queue.onSubmittedWorkDone(cbInfo);
 
-    configureSurface(surface, adapter, device);
+    int framebufferWidth = 0, framebufferHeight = 0;
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    surfaceWidth = static_cast<uint32_t>(framebufferWidth);
+    surfaceHeight = static_cast<uint32_t>(framebufferHeight);
+
+    configureSurface(surface, adapter, device, surfaceWidth, surfaceHeight);
 
     wgpu::ShaderModule triangleShader = createShaderModuleWGSL(RESOURCE_DIR "/shaders/shader.wgsl", device);
 
     wgpu::SurfaceCapabilities capabilities;
     surface.getCapabilities(adapter, &capabilities);
-    pipeline = createTrianglePipeline(device, capabilities.formats[0], triangleShader);
+    surfaceFormat = capabilities.formats[0];
+    pipeline = createTrianglePipeline(device, surfaceFormat, triangleShader);
 
     initializeBuffers();
+
+    if (scalingSettings.enabled) {
+        initializeScaling();
+    }
     return true;
 }
 
+// ---------------------------------------------------------
+// Records the draw calls for the scene geometry
+// ---------------------------------------------------------
+void Application::drawScene(wgpu::RenderPassEncoder& pass) {
+    pass.setPipeline(pipeline);
+
+    // vertex buffer
+    pass.setVertexBuffer(0, geometry.points, 0, geometry.points.getSize());
+
+    // index buffer
+    pass.setIndexBuffer(geometry.indices, wgpu::IndexFormat::Uint16, 0, geometry.indices.getSize());
+
+    pass.drawIndexed(geometry.indices.getSize() / sizeof(uint16_t), 1, 0, 0, 0);
+}
+
+// ---------------------------------------------------------
+// Renders the scene straight onto the surface
+// ---------------------------------------------------------
+void Application::renderDirect(wgpu::CommandEncoder& encoder, wgpu::TextureView targetView) {
+    wgpu::RenderPassColorAttachment colorAttachment = clearColorAttachment(targetView, { 0.0f, 0.0f, 0.0f, 1.0f });
+    wgpu::RenderPassDescriptor passDesc = { };
+
+    passDesc.colorAttachmentCount = 1;
+    passDesc.colorAttachments = &colorAttachment;
+
+    wgpu::RenderPassEncoder pass = encoder.beginRenderPass(passDesc);
+    drawScene(pass);
+    pass.end();
+}
+
+// ---------------------------------------------------------
+// Renders the scene at the current scale into the offscreen
+// target, then upscales it onto the surface
+// ---------------------------------------------------------
+void Application::renderScaled(wgpu::CommandEncoder& encoder, wgpu::TextureView targetView) {
+    const float scale = frameTimeController.scale();
+    const uint32_t width = std::clamp<uint32_t>(static_cast<uint32_t>(std::lround(surfaceWidth * scale)), 1u, offscreen.width);
+    const uint32_t height = std::clamp<uint32_t>(static_cast<uint32_t>(std::lround(surfaceHeight * scale)), 1u, offscreen.height);
+
+    BlitParams params = {
+        { static_cast<float>(width) / offscreen.width, static_cast<float>(height) / offscreen.height },
+        { 0.0f, 0.0f }
+    };
+    queue.writeBuffer(blitParams, 0, &params, sizeof(params));
+
+    // scene pass: only the top-left width x height region is rasterized.
+    // The clear still covers the whole max-scale texture: a scissor rect does not
+    // limit LoadOp::Clear, and switching to LoadOp::Load would read the old
+    // contents back in, which costs more than a clear on tiled GPUs. Desktop GPUs
+    // fast-clear through compression metadata, so the full clear is cheap. The
+    // region outside the viewport is never sampled because blit.wgsl clamps its UVs.
+    {
+        wgpu::RenderPassColorAttachment colorAttachment = clearColorAttachment(offscreen.view, { 0.0f, 0.0f, 0.0f, 1.0f });
+        wgpu::RenderPassDescriptor passDesc = { };
+
+        passDesc.colorAttachmentCount = 1;
+        passDesc.colorAttachments = &colorAttachment;
+        passDesc.timestampWrites = frameTimer.passTimestampWrites(true, false);
+
+        wgpu::RenderPassEncoder pass = encoder.beginRenderPass(passDesc);
+        pass.setViewport(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height), 0.0f, 1.0f);
+        drawScene(pass);
+        pass.end();
+    }
+
+    // blit pass: stretch that region over the whole surface
+    {
+        wgpu::RenderPassColorAttachment colorAttachment = clearColorAttachment(targetView, { 0.0f, 0.0f, 0.0f, 1.0f });
+        wgpu::RenderPassDescriptor passDesc = { };
+
+        passDesc.colorAttachmentCount = 1;
+        passDesc.colorAttachments = &colorAttachment;
+        passDesc.timestampWrites = frameTimer.passTimestampWrites(false, true);
+
+        wgpu::RenderPassEncoder pass = encoder.beginRenderPass(passDesc);
+        pass.setPipeline(blitPipeline);
+        pass.setBindGroup(0, blitBindGroup, 0, nullptr);
+        pass.draw(3, 1, 0, 0);
+        pass.end();
+    }
+
+    frameTimer.resolve(encoder);
+}
+
 // ---------------------------------------------------------
 // Runs the main rendering loop
 // ---------------------------------------------------------
@@ -88,33 +232,43 @@ void Application::mainLoop() {
             glfwSetWindowShouldClose(window, true);
         }
 
+        const double acquireStart = glfwGetTime();
         auto [surfaceTexture, targetView] = getNextSurfaceViewData(surface);
         if (!targetView) break;
 
+        if (scalingSettings.enabled) {
+            // Samples come from earlier frames whose timings have been read back.
+            // Collecting first frees their slots, so this frame can reuse one.
+            double frameMs = 0.0;
+            if (frameTimer.collect(frameMs)) {
+                const float previousScale = frameTimeController.scale();
+                const float scale = frameTimeController.update(frameMs);
+                if (scale != previousScale) {
+                    std::cout << "Render scale " << previousScale << " -> " << scale
+                              << " (avg " << frameTimeController.averageFrameMs() << " ms)\n";
+                }
+            }
+
+            frameTimer.beginFrame(glfwGetTime() - acquireStart);
+        }
+
         wgpu::CommandEncoderDescriptor encoderDesc = {};
         encoderDesc.label = toStringView("Encoder");
         wgpu::CommandEncoder encoder = device.createCommandEncoder(encoderDesc);
 
-        wgpu::RenderPassColorAttachment colorAttachment = clearColorAttachment(targetView, { 0.0f, 0.0f, 0.0f, 1.0f });
-        wgpu::RenderPassDescriptor passDesc = { };
-
-        passDesc.colorAttachmentCount = 1;
-        passDesc.colorAttachments = &colorAttachment;
-
-        wgpu::RenderPassEncoder pass = encoder.beginRenderPass(passDesc);
-        pass.setPipeline(pipeline);
-
-        // vertex buffer
-        pass.setVertexBuffer(0, geometry.points, 0, geometry.points.getSize());
-
-        // index buffer
-        pass.setIndexBuffer(geometry.indices, wgpu::IndexFormat::Uint16, 0, geometry.indices.getSize());
-
-        pass.drawIndexed(geometry.indices.getSize() / sizeof(uint16_t), 1, 0, 0, 0);
-        pass.end();
+        if (scalingSettings.enabled) {
+            renderScaled(encoder, targetView);
+        } else {
+            renderDirect(encoder, targetView);
+        }
 
         wgpu::CommandBuffer commands = encoder.finish();
         queue.submit(1, &commands);
+
+        if (scalingSettings.enabled) {
+            frameTimer.endFrame(queue);
+        }
+
         surface.present();
 
         glfwPollEvents();
@@ -1,13 +1,79 @@
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 #define WEBGPU_CPP_IMPLEMENTATION 
 #include "app.h"
 
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--adaptive-resolution] [--target-ms=<ms>]"
+              << " [--min-scale=<scale>] [--max-scale=<scale>] [--hysteresis=<fraction>]\n"
+              << "  --target-ms    frame budget in milliseconds, > 0 (default 16.6)\n"
+              << "  --min-scale    smallest render scale, > 0 (default 0.5)\n"
+              << "  --max-scale    largest render scale, >= min-scale (default 1.0)\n"
+              << "  --hysteresis   dead band below the budget, in [0, 1) (default 0.1)\n";
+}
 
+// Parses the whole string as a number; throws std::invalid_argument on trailing junk
+static double parseNumber(const std::string& text) {
+    size_t consumed = 0;
+    double value = std::stod(text, &consumed);
+    if (consumed != text.size() || !std::isfinite(value)) {
+        throw std::invalid_argument(text);
+    }
+    return value;
+}
+
+static bool parseArguments(int argc, char** argv, ResolutionScaleSettings& scaling) {
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--adaptive-resolution") {
+                scaling.enabled = true;
+            } else if (arg.rfind("--target-ms=", 0) == 0) {
+                scaling.targetFrameMs = parseNumber(arg.substr(12));
+            } else if (arg.rfind("--min-scale=", 0) == 0) {
+                scaling.minScale = static_cast<float>(parseNumber(arg.substr(12)));
+            } else if (arg.rfind("--max-scale=", 0) == 0) {
+                scaling.maxScale = static_cast<float>(parseNumber(arg.substr(12)));
+            } else if (arg.rfind("--hysteresis=", 0) == 0) {
+                scaling.hysteresis = static_cast<float>(parseNumber(arg.substr(13)));
+            } else {
+                std::cerr << "Unknown argument: " << arg << "\n";
+                return false;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Invalid numeric value in arguments\n";
+        return false;
+    }
 
-int main() {
+    if (scaling.targetFrameMs <= 0.0) {
+        std::cerr << "--target-ms must be greater than 0\n";
+        return false;
+    }
+    if (scaling.hysteresis < 0.0f || scaling.hysteresis >= 1.0f) {
+        std::cerr << "--hysteresis must be in [0, 1)\n";
+        return false;
+    }
+    if (scaling.minScale <= 0.0f || scaling.maxScale < scaling.minScale) {
+        std::cerr << "--min-scale must be greater than 0 and no larger than --max-scale\n";
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
     Application app;
 
-    if (!app.init()) {
+    ResolutionScaleSettings scaling;
+    if (!parseArguments(argc, argv, scaling)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (!app.init(scaling)) {
         return 1;
     }
 
@@ -16,4 +82,4 @@ int main() {
     app.terminate();
 
     return 0;
-}
\ No newline at end of file
+}